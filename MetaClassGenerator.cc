@@ -1,6 +1,8 @@
+#include <deque>
 #include <iostream>
 #include <sstream>
 #include <fstream>
+#include <vector>
 
 #include <clang/ASTMatchers/ASTMatchers.h>
 #include <clang/ASTMatchers/ASTMatchFinder.h>
@@ -10,6 +12,7 @@
 #include <clang/Tooling/Refactoring.h>
 #include <clang/Tooling/Tooling.h>
 
+#include <ipr/archive.H>
 #include <ipr/impl.H>
 #include <ipr/io.H>
 
@@ -24,7 +27,7 @@ using namespace ipr;
 class ClassMembersPrinter : public ast_matchers::MatchFinder::MatchCallback
 {
 public:
-   ClassMembersPrinter() {}
+  explicit ClassMembersPrinter(impl::Unit& unit) : lastFileIndex(0), unit(unit) {}
 
   virtual void run(const ast_matchers::MatchFinder::MatchResult &Result)
   {
@@ -34,16 +37,11 @@ public:
   }
 
   // -------------------------------------------------------------------------------------------------------------------
-  void writeMetaInfo()
-  {
-    std::cout << "Generated from " << fileName << ". Do not edit by hand.\n\n";
-    std::cout << "Classes:\n"
-                 "========" << classStream.str() << std::endl;;
-    std::cout << "Enums:\n"
-                 "======" << enumStream.str() << std::endl;
-    std::cout << "Iprs:\n"
-                 "=====\n" << iprStream.str() << std::endl;
-  }
+  // The parts of the report gathered by this printer; see WriteMetaInfo.
+  const std::string& lastFileName() const { return fileName; }
+  std::string classes() const { return classStream.str(); }
+  std::string enums() const { return enumStream.str(); }
+  std::string iprs() const { return iprStream.str(); }
 
 private:
 
@@ -70,12 +68,21 @@ private:
   void creatIprClass(const CXXRecordDecl* clangClass)
   {
     impl::Class& iprClass = *unit.make_class(*unit.global_region());
-    iprClass.id = unit.make_identifier(unit.get_string(clangClass->getNameAsString()));
-    unit.global_ns.declare_type(*iprClass.id, unit.get_class())->init = &iprClass;
+    iprClass.id = &unit.get_identifier(clangClass->getNameAsString());
+    impl::Typedecl* typeDecl = unit.global_ns.declare_type(*iprClass.id, unit.get_class());
+    typeDecl->init = &iprClass;
+    typeDecl->src_locus = sourceLocation(clangClass->getLocation());
+
+    std::vector<std::string> fieldNames;
+    for (auto it = clangClass->field_begin(); it != clangClass->field_end(); it++)
+      fieldNames.push_back((*it)->getNameAsString());
+    std::vector<const ipr::Identifier*> iprFieldNames(fieldNames.size());
+    unit.get_identifiers(fieldNames.data(), fieldNames.data() + fieldNames.size(), iprFieldNames.data());
 
+    std::size_t fieldIndex = 0;
     for (auto it = clangClass->field_begin(); it != clangClass->field_end(); it++)
     {
-      const ipr::Identifier& iprFieldName = unit.get_identifier((*it)->getNameAsString());
+      const ipr::Identifier& iprFieldName = *iprFieldNames[fieldIndex++];
       const ipr::Type* iprFieldType = &unit.get_void();
       if (const BuiltinType *BT = dyn_cast<BuiltinType>((*it)->getType()->getCanonicalTypeInternal()))
       {
@@ -145,6 +152,7 @@ private:
       }
       impl::Field* field = iprClass.declare_field(iprFieldName, *iprFieldType);
       field->decl_data.spec = ipr::Decl::Public;
+      field->src_locus = sourceLocation((*it)->getLocation());
     }
     Printer printer(iprStream);
     printer << "class: " << iprClass.name() << "\n";
@@ -181,13 +189,13 @@ private:
   void createIprEnum(const EnumDecl* clangEnum)
   {
     impl::Enum& iprEnum = *unit.make_enum(*unit.global_region());
-    iprEnum.id = unit.make_identifier(unit.get_string(clangEnum->getNameAsString()));
+    iprEnum.id = &unit.get_identifier(clangEnum->getNameAsString());
 
     for (auto it = clangEnum->enumerator_begin(); it != clangEnum->enumerator_end(); it++)
     {
        impl::Enumerator* enumerator = iprEnum.add_member(unit.get_identifier((*it)->getName().data()));
-       const std::string& enumInitAsStr = std::to_string((*it)->getInitVal().getSExtValue());
-       enumerator->init = &unit.get_literal(unit.get_int(), enumInitAsStr);
+       enumerator->init = &unit.get_integer_literal(unit.get_int(), (*it)->getInitVal().getSExtValue());
+       enumerator->src_locus = sourceLocation((*it)->getLocation());
     }
     Printer printer(iprStream);
       printer << "enum: " << iprEnum.name() << "\n";
@@ -214,18 +222,52 @@ private:
     enumStream << "\n";
   }
 
+  // -------------------------------------------------------------------------------------------------------------------
+  // Declarations come in runs from the same file, so the name and index of the last file are kept at hand.
+  ipr::Source_location sourceLocation(SourceLocation loc)
+  {
+    ipr::Source_location result;
+    PresumedLoc presumed = SM->getPresumedLoc(loc);
+    if (presumed.isInvalid())
+      return result;
+
+    if (presumed.getFilename() != lastFile)
+    {
+      lastFile = presumed.getFilename();
+      lastFileIndex = unit.make_fileindex(unit.get_string(lastFile));
+    }
+    result.file = lastFileIndex;
+    result.line = presumed.getLine();
+    result.column = presumed.getColumn();
+    return result;
+  }
+
   SourceManager* SM;
   std::string fileName;
+  std::string lastFile;
+  int lastFileIndex;
   std::stringstream classStream;
   std::stringstream enumStream;
   std::stringstream iprStream;
-  impl::Unit unit;
+  // Shared by the printers of all parsing threads.
+  impl::Unit& unit;
 };
 
 // =====================================================================================================================
+static impl::Unit& SharedUnit()
+{
+  static impl::Unit unit;
+  return unit;
+}
+
+// =====================================================================================================================
+// One printer per parsing thread, all building into the same Unit.  Printers are only created from the main thread,
+// before the parsing threads start.
 ClassMembersPrinter& GenerateSerialization(tooling::RefactoringTool& tool, ast_matchers::MatchFinder& finder)
 {
-  static ClassMembersPrinter classMembersPrinter;
+  static std::deque<ClassMembersPrinter> printers;
+  printers.emplace_back(SharedUnit());
+  ClassMembersPrinter& classMembersPrinter = printers.back();
   finder.addMatcher(recordDecl().bind("classDecl"), &classMembersPrinter);
   finder.addMatcher(enumDecl().bind("enumDecl"), &classMembersPrinter);
 
@@ -233,7 +275,35 @@ ClassMembersPrinter& GenerateSerialization(tooling::RefactoringTool& tool, ast_m
 }
 
 // =====================================================================================================================
-void WriteMetaInfo(ClassMembersPrinter& printer)
+// One report for all printers, their parts joined in the order of the printers.  Each printer was given a run of
+// consecutive sources, so the report is the same whatever the number of threads.
+void WriteMetaInfo(const std::vector<ClassMembersPrinter*>& printers)
+{
+  std::string fileName;
+  std::string classes, enums, iprs;
+  for (const ClassMembersPrinter* printer : printers)
+  {
+    if (!printer->lastFileName().empty())
+      fileName = printer->lastFileName();
+    classes += printer->classes();
+    enums += printer->enums();
+    iprs += printer->iprs();
+  }
+
+  std::cout << "Generated from " << fileName << ". Do not edit by hand.\n\n";
+  std::cout << "Classes:\n"
+               "========" << classes << std::endl;;
+  std::cout << "Enums:\n"
+               "======" << enums << std::endl;
+  std::cout << "Iprs:\n"
+               "=====\n" << iprs << std::endl;
+}
+
+// =====================================================================================================================
+void SaveIpr(const std::string& path)
 {
-  printer.writeMetaInfo();
+  std::ofstream out(path.c_str(), std::ios::binary);
+  impl::write_archive(out, SharedUnit());
+  if (!out)
+    llvm::report_fatal_error("cannot write " + path);
 }
@@ -1,10 +1,12 @@
 #ifndef __Generator_MetaClassGenerator_H__
 #define __Generator_MetaClassGenerator_H__
+#include <vector>
 #include <clang/Tooling/Refactoring.h>
 #include <clang/ASTMatchers/ASTMatchFinder.h>
 
 class ClassMembersPrinter;
 
 ClassMembersPrinter& GenerateSerialization(clang::tooling::RefactoringTool& tool, clang::ast_matchers::MatchFinder& finder);
-void WriteMetaInfo(ClassMembersPrinter& printer);
+void WriteMetaInfo(const std::vector<ClassMembersPrinter*>& printers);
+void SaveIpr(const std::string& path);
 #endif
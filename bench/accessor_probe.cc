@@ -0,0 +1,107 @@
+// Probes for optional parts of nodes the way traversals used to -- by
+// calling the accessor and catching the exception -- against the has_*
+// members and Sequence<>::try_get.  Also times reading a sequence
+// through operator[] and through ref_sequence<>::unchecked_get.
+//
+//   bench_accessor_probe [count]
+
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+#include "ipr/impl.H"
+#include "fixture.H"
+
+using namespace ipr;
+using namespace bench;
+
+namespace {
+  const ipr::Type* element_by_catch(const ipr::Sequence<ipr::Type>& s, int p)
+  {
+    try {
+      return &s[p];
+    }
+    catch (const std::domain_error&) {
+      return 0;
+    }
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  const int count = argc > 1 ? std::atoi(argv[1]) : 100000;
+
+  // Every other mapping has a body, as function templates declared
+  // then defined; every other id-expression is resolved.
+  impl::Unit unit;
+  impl::Var& var = *unit.global_ns.declare_var(unit.get_identifier("v"),
+                                               unit.get_int());
+  std::vector<const ipr::Mapping*> maps;
+  std::vector<const ipr::Id_expr*> ids;
+  for (int i = 0; i < count; ++i) {
+    impl::Mapping& m = *unit.make_mapping(*unit.global_region());
+    impl::Id_expr& id = *unit.make_id_expr(unit.get_identifier("v"));
+    if (i % 2 == 0) {
+      m.body = &unit.get_literal(unit.get_int(), "0");
+      id.decl = &var;
+    }
+    maps.push_back(&m);
+    ids.push_back(&id);
+  }
+
+  long by_catch = 0, by_member = 0;
+  clock_type::time_point start = clock_type::now();
+  for (int i = 0; i < count; ++i) {
+    by_catch += util::node_has_member(*maps[i], &ipr::Mapping::result);
+    by_catch += util::node_has_member(*ids[i], &ipr::Id_expr::resolution);
+  }
+  double catch_ms = elapsed_ms(start);
+  start = clock_type::now();
+  for (int i = 0; i < count; ++i)
+    by_member += maps[i]->has_result() + ids[i]->has_resolution();
+  double member_ms = elapsed_ms(start);
+  std::printf("%d mappings and ids:  catching %8.2f ms, has_* %8.3f ms%s\n",
+              count, catch_ms, member_ms,
+              by_catch == by_member && by_member == count ? "" : "  MISMATCH");
+
+  // Probe one past the end as often as within.
+  impl::ref_sequence<ipr::Type> seq;
+  for (int i = 0; i < 16; ++i)
+    seq.push_back(&unit.get_pointer(i % 2 ? (const ipr::Type&)unit.get_int()
+                                    : unit.get_char()));
+  // As traversals see it: through the interface, out of the
+  // optimizer's sight.
+  const ipr::Sequence<ipr::Type>* volatile opaque = &seq;
+  const ipr::Sequence<ipr::Type>& s = *opaque;
+  by_catch = by_member = 0;
+  start = clock_type::now();
+  for (int i = 0; i < count; ++i)
+    by_catch += element_by_catch(s, i % 32) != 0;
+  catch_ms = elapsed_ms(start);
+  start = clock_type::now();
+  for (int i = 0; i < count; ++i)
+    by_member += s.try_get(i % 32) != 0;
+  member_ms = elapsed_ms(start);
+  std::printf("%d sequence probes:   catching %8.2f ms, try_get %6.3f ms%s\n",
+              count, catch_ms, member_ms,
+              by_catch == by_member ? "" : "  MISMATCH");
+
+  const int rounds = count * 10;
+  long checked = 0, unchecked = 0;
+  start = clock_type::now();
+  for (int r = 0; r < rounds; ++r)
+    for (int i = 0; i < s.size(); ++i)
+      checked += s[i].node_id;
+  double checked_ms = elapsed_ms(start);
+  start = clock_type::now();
+  for (int r = 0; r < rounds; ++r)
+    for (int i = 0; i < seq.size(); ++i)
+      unchecked += seq.unchecked_get(i).node_id;
+  double unchecked_ms = elapsed_ms(start);
+  std::printf("%d reads of 16:   operator[] %8.2f ms, unchecked %6.2f ms%s\n",
+              rounds, checked_ms, unchecked_ms,
+              checked == unchecked ? "" : "  MISMATCH");
+
+  return by_catch == by_member && checked == unchecked ? 0 : 1;
+}
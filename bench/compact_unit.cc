@@ -0,0 +1,110 @@
+// Makes a compact copy of a unit of generated classes, and compares its
+// size with the memory census of the unit, and the time to walk the
+// types of all fields through handles with the time through ipr::Node.
+//
+//   bench_compact_unit [class-count] [rounds]
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "ipr/impl.H"
+#include "ipr/compact.H"
+#include "fixture.H"
+
+using namespace ipr;
+using namespace bench;
+
+namespace {
+  // A member function declaration to each class.
+  struct with_size : class_layout {
+    void add_to_class(impl::Unit& unit, impl::Class& cls, impl::Typedecl&,
+                      int)
+    {
+      impl::ref_sequence<ipr::Type> args;
+      args.push_back(&unit.get_pointer(cls));
+      cls.declare_fun(unit.get_identifier("size"),
+                      unit.get_function(unit.get_product(args),
+                                        unit.get_int()));
+    }
+  };
+
+  // Count the fields whose type is a pointer to a class.
+  long walk(const std::vector<const ipr::Field*>& fields)
+  {
+    long n = 0;
+    for (std::size_t i = 0; i < fields.size(); ++i) {
+      const ipr::Type& t = fields[i]->type();
+      if (t.category == pointer_cat
+          && static_cast<const ipr::Pointer&>(t).points_to().category
+             == class_cat)
+        ++n;
+    }
+    return n;
+  }
+
+  long walk(const impl::compact_unit& cu)
+  {
+    typedef impl::compact_unit::handle handle;
+    long n = 0;
+    const handle first = cu.first(field_cat);
+    const handle last = first + cu.count(field_cat);
+    for (handle h = first; h != last; ++h) {
+      const handle t = cu.operand(h, 1);
+      if (cu.category(t) == pointer_cat
+          && cu.category(cu.operand(t, 0)) == class_cat)
+        ++n;
+    }
+    return n;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  const int count = argc > 1 ? std::atoi(argv[1]) : 20000;
+  const int rounds = argc > 2 ? std::atoi(argv[2]) : 20;
+
+  impl::Unit unit;
+  with_size layout;
+  make_classes(unit, count, layout);
+  const long long unit_bytes = unit.usage().byte_count();
+
+  clock_type::time_point start = clock_type::now();
+  impl::compact_unit cu(unit);
+  double compact_ms = elapsed_ms(start);
+
+  std::vector<const ipr::Field*> fields;
+  const ipr::Sequence<ipr::Decl>& spaces = unit.get_global_scope().members();
+  for (int i = 0; i < spaces.size(); ++i) {
+    const ipr::Expr& ns = spaces[i].initializer();
+    const ipr::Scope& s = static_cast<const ipr::Udt&>(ns).scope();
+    for (int j = 0; j < s.size(); ++j) {
+      const ipr::Expr& cls = s[j].initializer();
+      const ipr::Scope& m = static_cast<const ipr::Udt&>(cls).scope();
+      for (int k = 0; k < m.size(); ++k)
+        if (m[k].category == field_cat)
+          fields.push_back(static_cast<const ipr::Field*>(&m[k]));
+    }
+  }
+
+  long by_node = 0;
+  start = clock_type::now();
+  for (int r = 0; r < rounds; ++r)
+    by_node += walk(fields);
+  double node_ms = elapsed_ms(start);
+
+  long by_handle = 0;
+  start = clock_type::now();
+  for (int r = 0; r < rounds; ++r)
+    by_handle += walk(cu);
+  double handle_ms = elapsed_ms(start);
+
+  std::printf("%d classes: %d nodes, compact %lu bytes against %lld"
+              " (%.1f ms to make)\n", count, cu.size(),
+              (unsigned long)cu.bytes(), unit_bytes, compact_ms);
+  std::printf("%d rounds over %lu fields: nodes %.1f ms, handles %.1f ms"
+              " (%ld, %ld)\n", rounds, (unsigned long)fields.size(),
+              node_ms, handle_ms, by_node, by_handle);
+  return by_node == by_handle ? 0 : 1;
+}
@@ -0,0 +1,129 @@
+// Looks up fields of generated classes by name, from one thread and from
+// several, in the scopes of an impl::Unit and in the name tables of its
+// frozen copy.
+//
+//   bench_frozen_lookup [class-count] [threads]
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ipr/impl.H"
+#include "ipr/compact.H"
+#include "fixture.H"
+
+using namespace ipr;
+using namespace bench;
+
+namespace {
+  typedef impl::compact_unit::handle handle;
+
+  const long lookups = 4000000;
+
+  // The only member of SCOPE spelled S, or no_handle.
+  handle member(const impl::compact_unit& cu, handle scope,
+                const std::string& s)
+  {
+    impl::compact_unit::range r = cu.lookup(scope, s.data(), s.size());
+    return r.size() == 1 ? *r.first : impl::compact_unit::no_handle;
+  }
+
+  struct query {
+    const ipr::Scope* scope;
+    const ipr::Name* name;
+    handle frozen_scope;
+    handle frozen_name;
+    std::string text;
+  };
+
+  // Wall-clock milliseconds for THREADS threads to share LOOKUPS calls
+  // of F(q), cycling over QUERIES; the sum of the results goes to FOUND.
+  template<class F>
+  double run(const std::vector<query>& queries, int threads, F f,
+             long& found)
+  {
+    std::atomic<long> total(0);
+    std::vector<std::thread> pool;
+    clock_type::time_point start = clock_type::now();
+    for (int t = 0; t < threads; ++t)
+      pool.push_back(std::thread([&, t] {
+        long n = 0;
+        const std::size_t m = queries.size();
+        for (long i = t; i < lookups; i += threads)
+          n += f(queries[(i * 7919) % m]);
+        total += n;
+      }));
+    for (int t = 0; t < threads; ++t)
+      pool[t].join();
+    found = total;
+    return elapsed_ms(start);
+  }
+
+  void report(const char* what, double one_ms, double many_ms, int threads,
+              long found)
+  {
+    std::printf("%-22s 1 thread %7.1f ns/lookup, %d threads %7.1f ns/lookup"
+                "%s\n", what, one_ms * 1e6 / lookups, threads,
+                many_ms * 1e6 / lookups, found == lookups ? "" : "  MISMATCH");
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  const int count = argc > 1 ? std::atoi(argv[1]) : 20000;
+  const int threads = argc > 2 ? std::atoi(argv[2])
+                    : std::max(2U, std::thread::hardware_concurrency());
+
+  impl::Unit unit;
+  std::vector<impl::Class*> classes = make_classes(unit, count);
+
+  clock_type::time_point start = clock_type::now();
+  const impl::compact_unit cu = impl::freeze(unit);
+  double freeze_ms = elapsed_ms(start);
+  std::printf("%d classes: frozen in %.1f ms, %lu bytes\n", count,
+              freeze_ms, (unsigned long)cu.bytes());
+
+  // Reach each class of the frozen copy through the name tables.
+  std::vector<query> queries(1 << 14);
+  std::srand(42);
+  for (std::size_t i = 0; i < queries.size(); ++i) {
+    const int c = std::rand() % count;
+    const int f = std::rand() % 12;
+    query& q = queries[i];
+    q.scope = &classes[c]->scope();
+    q.text = "field_" + std::to_string(f);
+    q.name = &unit.get_identifier(q.text);
+
+    handle ns = member(cu, cu.global_scope(), "ns_" + std::to_string(c / 100));
+    ns = cu.operand(ns, 3);
+    const handle cls = member(cu, ns, "class_" + std::to_string(c));
+    q.frozen_scope = cu.operand(cls, 3);
+    q.frozen_name = cu.find_identifier(q.text.data(), q.text.size());
+  }
+
+  long found;
+  auto by_scope = [](const query& q) { return (*q.scope)[*q.name].size(); };
+  auto by_handle = [&cu](const query& q) {
+    return cu.lookup(q.frozen_scope, q.frozen_name).size();
+  };
+  auto by_text = [&cu](const query& q) {
+    return cu.lookup(q.frozen_scope, q.text.data(), q.text.size()).size();
+  };
+
+  double one = run(queries, 1, by_scope, found);
+  double many = run(queries, threads, by_scope, found);
+  report("impl::Scope", one, many, threads, found);
+
+  one = run(queries, 1, by_handle, found);
+  many = run(queries, threads, by_handle, found);
+  report("frozen, by name node", one, many, threads, found);
+
+  one = run(queries, 1, by_text, found);
+  many = run(queries, threads, by_text, found);
+  report("frozen, by text", one, many, threads, found);
+}
@@ -0,0 +1,80 @@
+// Times checked downcasts of nodes: util::view<T> through the category
+// code against the visitor-based test it replaces.
+//
+//   bench_node_view [type-count] [rounds]
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "ipr/impl.H"
+#include "ipr/traversal.H"
+#include "fixture.H"
+
+using namespace ipr;
+using namespace bench;
+
+namespace {
+  // The former util::view<T>.
+  template<class T>
+  const T* view_by_visitor(const Node& n)
+  {
+    util::view_visitor<T> vis;
+    n.accept(vis);
+    return vis.result;
+  }
+
+  // A mix of classes, pointers, functions and built-in types.
+  void fill(impl::Unit& unit, int count, std::vector<const Node*>& nodes)
+  {
+    for (int c = 0; c < count; ++c) {
+      impl::Class& cls = *unit.make_class(*unit.global_region());
+      cls.id = &unit.get_identifier("class_" + std::to_string(c));
+      impl::ref_sequence<ipr::Type> params;
+      params.push_back(&unit.get_pointer(cls));
+      nodes.push_back(&cls);
+      nodes.push_back(&params.get(0));
+      nodes.push_back(&unit.get_function(unit.get_product(params),
+                                         unit.get_int()));
+      if (c % 2)
+        nodes.push_back(&unit.get_int());
+      else
+        nodes.push_back(&unit.get_double());
+    }
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  const int count = argc > 1 ? std::atoi(argv[1]) : 10000;
+  const int rounds = argc > 2 ? std::atoi(argv[2]) : 200;
+
+  impl::Unit unit;
+  std::vector<const Node*> nodes;
+  fill(unit, count, nodes);
+  const long tests = 3L * rounds * nodes.size();
+
+  long found = 0;
+  clock_type::time_point start = clock_type::now();
+  for (int r = 0; r < rounds; ++r)
+    for (std::size_t i = 0; i < nodes.size(); ++i)
+      found += (view_by_visitor<Function>(*nodes[i]) != 0)
+        + (view_by_visitor<Udt>(*nodes[i]) != 0)
+        + (view_by_visitor<Int>(*nodes[i]) != 0);
+  double visitor_ms = elapsed_ms(start);
+
+  long found_by_category = 0;
+  start = clock_type::now();
+  for (int r = 0; r < rounds; ++r)
+    for (std::size_t i = 0; i < nodes.size(); ++i)
+      found_by_category += (util::view<Function>(*nodes[i]) != 0)
+        + (util::view<Udt>(*nodes[i]) != 0)
+        + (util::view<Int>(*nodes[i]) != 0);
+  double category_ms = elapsed_ms(start);
+
+  std::printf("%ld tests: visitor %.1f ns/test, category %.1f ns/test "
+              "(%.1fx)%s\n", tests, visitor_ms * 1e6 / tests,
+              category_ms * 1e6 / tests, visitor_ms / category_ms,
+              found == found_by_category ? "" : ", RESULTS DIFFER");
+}
@@ -0,0 +1,180 @@
+// Makes the enumerator values of generated enums the way the generator
+// did -- formatting each with std::to_string and interning the text --
+// and from native numbers, then reads them back as a consumer would:
+// parsing the text, or asking the literal for its value.  Also checks
+// that both ways give literals of the same text and number, one node
+// per type and text in a unit, and the same archive.
+//
+//   bench_numeric_literals [enum-count]
+
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ipr/impl.H"
+#include "ipr/archive.H"
+#include "fixture.H"
+
+using namespace ipr;
+using namespace bench;
+
+namespace {
+  // Enums of 16 enumerators, the values of flags and of plain counts.
+  long long value_of(int e, int k)
+  {
+    return e % 2 ? 1LL << (k + e % 40) : k - 8 + e;
+  }
+
+  void fill(impl::Unit& unit, int count, bool native,
+            std::vector<const ipr::Enumerator*>& out)
+  {
+    for (int e = 0; e < count; ++e) {
+      impl::Enum& en = *unit.make_enum(*unit.global_region());
+      en.id = &unit.get_identifier("enum_" + std::to_string(e));
+      unit.global_ns.declare_type(*en.id, unit.get_enum())->init = &en;
+      for (int k = 0; k < 16; ++k) {
+        impl::Enumerator& x = *en.add_member(
+          unit.get_identifier("value_" + std::to_string(k)));
+        const long long v = value_of(e, k);
+        x.init = native
+          ? &unit.get_integer_literal(unit.get_int(), v)
+          : &unit.get_literal(unit.get_int(), std::to_string(v));
+        out.push_back(&x);
+      }
+    }
+  }
+
+  long long read_back(const std::vector<const ipr::Enumerator*>& xs,
+                      bool parse)
+  {
+    long long sum = 0;
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+      const ipr::Literal& l =
+        static_cast<const ipr::Literal&>(xs[i]->initializer());
+      if (!parse && l.value_kind() == ipr::Literal::signed_integer)
+        sum += l.signed_value();
+      else {
+        const ipr::String& s = l.string();
+        sum += std::strtoll(std::string(s.begin(), s.end()).c_str(), 0, 10);
+      }
+    }
+    return sum;
+  }
+
+  bool same_literals(const std::vector<const ipr::Enumerator*>& xs,
+                     const std::vector<const ipr::Enumerator*>& ys)
+  {
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+      const ipr::Literal& x =
+        static_cast<const ipr::Literal&>(xs[i]->initializer());
+      const ipr::Literal& y =
+        static_cast<const ipr::Literal&>(ys[i]->initializer());
+      const ipr::String& s = x.string();
+      const ipr::String& t = y.string();
+      if (std::string(s.begin(), s.end()) != std::string(t.begin(), t.end())
+          || x.value_kind() != ipr::Literal::signed_integer
+          || y.value_kind() != ipr::Literal::signed_integer
+          || x.signed_value() != y.signed_value())
+        return false;
+    }
+    return true;
+  }
+
+  // Whether the literals made from text and from numbers in one unit
+  // are the same nodes.
+  bool one_node_each(int count)
+  {
+    impl::Unit unit;
+    for (int e = 0; e < count; ++e)
+      for (int k = 0; k < 16; ++k) {
+        const long long v = value_of(e, k);
+        if (&unit.get_literal(unit.get_int(), std::to_string(v))
+            != &unit.get_integer_literal(unit.get_int(), v))
+          return false;
+      }
+    return &unit.get_floating_literal(unit.get_double(), 0.1)
+      == &unit.get_literal(unit.get_double(), "0.1");
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  const int count = argc > 1 ? std::atoi(argv[1]) : 20000;
+
+  // Alternate the two, keeping the best of three rounds of each.
+  double text_ms = 1e9, native_ms = 1e9;
+  for (int round = 0; round < 3; ++round) {
+    std::vector<const ipr::Enumerator*> xs;
+    clock_type::time_point start = clock_type::now();
+    {
+      impl::Unit unit;
+      fill(unit, count, false, xs);
+    }
+    text_ms = std::min(text_ms, elapsed_ms(start));
+    xs.clear();
+    start = clock_type::now();
+    {
+      impl::Unit unit;
+      fill(unit, count, true, xs);
+    }
+    native_ms = std::min(native_ms, elapsed_ms(start));
+  }
+
+  impl::Unit text_unit, native_unit;
+  std::vector<const ipr::Enumerator*> by_text, by_value;
+  fill(text_unit, count, false, by_text);
+  fill(native_unit, count, true, by_value);
+  std::printf("%d enumerators: build from text %.1f ms, from values %.1f ms;"
+              " %.2f MB against %.2f MB\n", (int)by_text.size(), text_ms,
+              native_ms, text_unit.usage().byte_count() / 1e6,
+              native_unit.usage().byte_count() / 1e6);
+
+  clock_type::time_point start = clock_type::now();
+  const long long parsed = read_back(by_value, true);
+  const double parse_ms = elapsed_ms(start);
+  start = clock_type::now();
+  const long long native = read_back(by_value, false);
+  const double value_ms = elapsed_ms(start);
+  std::printf("read back: parsing %.2f ms, native %.2f ms%s\n",
+              parse_ms, value_ms, parsed == native ? "" : "  MISMATCH");
+
+  const bool same = same_literals(by_text, by_value);
+  const bool shared = one_node_each(count);
+  std::printf("same text and number: %s; one node per type and text: %s\n",
+              same ? "yes" : "NO", shared ? "yes" : "NO");
+
+  std::ostringstream text_os;
+  impl::write_archive(text_os, text_unit);
+  std::ostringstream os;
+  impl::write_archive(os, native_unit);
+  const std::string data = os.str();
+  impl::Unit copy;
+  impl::read_archive(data.data(), data.data() + data.size(), copy);
+  const ipr::Scope& s = copy.get_global_scope().scope();
+  long long archived = 0;
+  long long natives = 0;
+  for (int i = 0; i < s.size(); ++i) {
+    if (!s[i].has_initializer() || s[i].initializer().category != enum_cat)
+      continue;
+    const ipr::Sequence<ipr::Enumerator>& m =
+      static_cast<const ipr::Enum&>(s[i].initializer()).members();
+    for (int k = 0; k < m.size(); ++k) {
+      const ipr::Literal& l =
+        static_cast<const ipr::Literal&>(m[k].initializer());
+      natives += l.value_kind() == ipr::Literal::signed_integer;
+      archived += l.signed_value();
+    }
+  }
+  const std::size_t text_size = text_os.str().size();
+  std::printf("archive: built from text %lu bytes, from values %lu bytes,"
+              " %lld native values read back%s\n", (unsigned long)text_size,
+              (unsigned long)data.size(), natives,
+              archived == native && text_size == data.size()
+              ? "" : "  MISMATCH");
+
+  return parsed == native && same && shared && archived == native
+    && text_size == data.size() && natives == (long long)by_value.size()
+    ? 0 : 1;
+}
@@ -0,0 +1,65 @@
+// Times a whole-unit analysis -- counting fields and the bytes of their
+// names -- with ipr::parallel_visit on one thread and on several.
+//
+//   bench_parallel_visit [class-count] [threads]
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+#include "ipr/impl.H"
+#include "ipr/parallel.H"
+#include "ipr/traversal.H"
+#include "fixture.H"
+
+using namespace ipr;
+using namespace bench;
+
+namespace {
+  struct field_stats : Constant_visitor<No_op> {
+    long fields;
+    long name_bytes;
+    field_stats() : fields(0), name_bytes(0) { }
+
+    void visit(const Field& f)
+    {
+      ++fields;
+      if (const Identifier* id = util::view<Identifier>(f.name()))
+        name_bytes += id->string().size();
+    }
+  };
+
+  void add(field_stats& x, const field_stats& y)
+  {
+    x.fields += y.fields;
+    x.name_bytes += y.name_bytes;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  const int count = argc > 1 ? std::atoi(argv[1]) : 50000;
+  const int threads = argc > 2 ? std::atoi(argv[2])
+                    : std::max(2U, std::thread::hardware_concurrency());
+
+  impl::Unit unit;
+  class_layout layout(1000);
+  make_classes(unit, count, layout);
+
+  clock_type::time_point start = clock_type::now();
+  field_stats serial = parallel_visit(unit, field_stats(), add, 1);
+  double serial_ms = elapsed_ms(start);
+
+  start = clock_type::now();
+  field_stats parallel = parallel_visit(unit, field_stats(), add, threads);
+  double parallel_ms = elapsed_ms(start);
+
+  std::printf("%ld fields: 1 thread %.1f ms, %d threads %.1f ms (%.1fx)%s\n",
+              serial.fields, serial_ms, threads, parallel_ms,
+              serial_ms / parallel_ms,
+              serial.fields == parallel.fields
+              && serial.name_bytes == parallel.name_bytes
+              ? "" : ", RESULTS DIFFER");
+}
@@ -0,0 +1,171 @@
+// Answers the queries of code-generation plugins -- the classes with a
+// field of a given type, the enums of a namespace, the declarations of a
+// qualified name -- through an impl::query_index, and by walking the
+// unit as they had to before.  Also times building the unit with and
+// without the index attached.
+//
+//   bench_query_index [class-count] [queries]
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "ipr/impl.H"
+#include "ipr/query.H"
+#include "fixture.H"
+
+using namespace ipr;
+using namespace bench;
+
+namespace {
+  // An enum to each namespace.
+  struct with_enum : class_layout {
+    void add_to_namespace(impl::Unit& unit, impl::Namespace& ns, int)
+    {
+      impl::Enum& e = *unit.make_enum(ns.body);
+      e.id = &unit.get_identifier("kind");
+      ns.declare_type(*e.id, unit.get_enum())->init = &e;
+      for (int k = 0; k < 4; ++k)
+        e.add_member(unit.get_identifier("kind_" + std::to_string(k)));
+    }
+  };
+
+  const ipr::Scope& scope_of(const ipr::Decl& d)
+  {
+    return static_cast<const ipr::Udt&>(d.initializer()).scope();
+  }
+
+  // The classes with a field of type T, by walking the unit.
+  long walk_fields_of_type(const ipr::Unit& unit, const ipr::Type& t)
+  {
+    long n = 0;
+    const ipr::Scope& global = unit.get_global_scope().scope();
+    for (int i = 0; i < global.size(); ++i) {
+      const ipr::Scope& ns = scope_of(global[i]);
+      for (int j = 0; j < ns.size(); ++j) {
+        if (ns[j].initializer().category != class_cat)
+          continue;
+        const ipr::Scope& cls = scope_of(ns[j]);
+        for (int k = 0; k < cls.size(); ++k)
+          if (cls[k].category == field_cat && &cls[k].type() == &t) {
+            ++n;
+            break;
+          }
+      }
+    }
+    return n;
+  }
+
+  long index_fields_of_type(const impl::query_index& qi, const ipr::Type& t)
+  {
+    const impl::query_index::decl_list& v = qi.fields_of_type(t);
+    const ipr::Udt* last = 0;
+    long n = 0;
+    for (std::size_t i = 0; i < v.size(); ++i) {
+      const ipr::Udt& u = static_cast<const ipr::Field*>(v[i])->membership();
+      if (&u != last)
+        ++n;
+      last = &u;
+    }
+    return n;
+  }
+
+  // The enums of the namespace named NAME, by walking the unit.
+  long walk_enums(const ipr::Unit& unit, const ipr::Name& name)
+  {
+    long n = 0;
+    const ipr::Scope& global = unit.get_global_scope().scope();
+    for (int i = 0; i < global.size(); ++i) {
+      if (&global[i].name() != &name)
+        continue;
+      const ipr::Scope& ns = scope_of(global[i]);
+      for (int j = 0; j < ns.size(); ++j)
+        n += ns[j].initializer().category == enum_cat;
+    }
+    return n;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  const int count = argc > 1 ? std::atoi(argv[1]) : 20000;
+  const int queries = argc > 2 ? std::atoi(argv[2]) : 1000;
+  const int walks = std::max(1, queries / 100);
+  with_enum layout;
+
+  // The first build warms up the allocator; time the second.
+  double plain_ms = 0;
+  for (int round = 0; round < 2; ++round) {
+    clock_type::time_point start = clock_type::now();
+    impl::Unit plain;
+    make_classes(plain, count, layout);
+    plain_ms = elapsed_ms(start);
+  }
+
+  clock_type::time_point start = clock_type::now();
+
+  impl::Unit unit;
+  impl::query_index qi(unit);
+  std::vector<impl::Class*> classes = make_classes(unit, count, layout);
+  double indexed_ms = elapsed_ms(start);
+  std::printf("%d classes: build %.1f ms, with the index %.1f ms\n",
+              count, plain_ms, indexed_ms);
+
+  // Classes with a field pointing to class_C.
+  std::vector<const ipr::Type*> types;
+  std::vector<const ipr::Udt*> spaces;
+  for (int q = 0; q < queries; ++q) {
+    const impl::Class& cls = *classes[q * 7919 % count];
+    types.push_back(&unit.get_pointer(cls));
+    spaces.push_back(&static_cast<const ipr::Udt&>(cls.region().enclosing()
+                                                   .owner()));
+  }
+
+  long by_walk = 0, by_index = 0;
+  start = clock_type::now();
+  for (int q = 0; q < walks; ++q)
+    by_walk += walk_fields_of_type(unit, *types[q]);
+  double walk_ms = elapsed_ms(start) / walks;
+  start = clock_type::now();
+  for (int q = 0; q < queries; ++q)
+    by_index += index_fields_of_type(qi, *types[q]);
+  double index_ms = elapsed_ms(start) / queries;
+  std::printf("classes with a field of type T:  walk %9.3f ms,"
+              " index %9.6f ms%s\n", walk_ms, index_ms,
+              by_walk == walks && by_index == queries ? "" : "  MISMATCH");
+
+  by_walk = by_index = 0;
+  start = clock_type::now();
+  for (int q = 0; q < walks; ++q)
+    by_walk += walk_enums(unit, spaces[q]->name());
+  walk_ms = elapsed_ms(start) / walks;
+  start = clock_type::now();
+  for (int q = 0; q < queries; ++q)
+    by_index += qi.members(*spaces[q], enum_cat).size();
+  index_ms = elapsed_ms(start) / queries;
+  std::printf("enums of namespace N:            walk %9.3f ms,"
+              " index %9.6f ms%s\n", walk_ms, index_ms,
+              by_walk == walks && by_index == queries ? "" : "  MISMATCH");
+
+  std::vector<std::string> names;
+  for (int q = 0; q < queries; ++q) {
+    const int c = q * 7919 % count;
+    names.push_back("ns_" + std::to_string(c / 100) + "::class_"
+                    + std::to_string(c) + "::field_" + std::to_string(q % 12));
+  }
+  start = clock_type::now();
+  by_index = qi.decls(names[0]).size();
+  double first_ms = elapsed_ms(start);
+  start = clock_type::now();
+  for (int q = 0; q < queries; ++q)
+    by_index += qi.decls(names[q]).size();
+  index_ms = elapsed_ms(start) / queries;
+  std::printf("decls of a qualified name:       first %8.1f ms,"
+              " then %9.6f ms%s\n", first_ms, index_ms,
+              by_index == queries + 1 ? "" : "  MISMATCH");
+
+  std::printf("every Class node: %lu\n",
+              (unsigned long)qi.nodes(class_cat).size());
+}
@@ -0,0 +1,81 @@
+// Compares overload-set lookup in impl::Scope (open-addressing index
+// keyed by name node_id) with the red-black tree it replaced.
+//
+//   bench_scope_lookup [scope-size...]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "ipr/impl.H"
+#include "fixture.H"
+
+using namespace ipr;
+using namespace bench;
+
+namespace {
+  // The former Scope::overloads representation.
+  struct by_name {
+    int operator()(const ipr::Name& n, const impl::Overload& ovl) const
+    {
+      return impl::compare(n, ovl.name);
+    }
+  };
+
+  double elapsed_ns(clock_type::time_point start, long ops)
+  {
+    std::chrono::duration<double, std::nano> d = clock_type::now() - start;
+    return d.count() / ops;
+  }
+
+  void run(int scope_size)
+  {
+    impl::Unit unit;
+    impl::Scope& scope = *unit.global_scope();
+    util::rb_tree::container<impl::Overload> tree;
+    std::vector<const ipr::Name*> names;
+
+    for (int i = 0; i < scope_size; ++i) {
+      const ipr::Name& n = unit.get_identifier("decl_" + std::to_string(i));
+      names.push_back(&n);
+      unit.global_ns.declare_var(n, unit.get_int());
+      tree.insert(n, by_name());
+    }
+
+    // Visit the names in a scattered, but reproducible, order.
+    const long lookups = 4000000;
+    std::vector<int> order(1 << 16);
+    std::srand(42);
+    for (std::size_t i = 0; i < order.size(); ++i)
+      order[i] = std::rand() % scope_size;
+
+    long found = 0;
+    clock_type::time_point start = clock_type::now();
+    for (long i = 0; i < lookups; ++i)
+      found += tree.find(*names[order[i & 0xffff]], by_name()) != 0;
+    double tree_ns = elapsed_ns(start, lookups);
+
+    start = clock_type::now();
+    for (long i = 0; i < lookups; ++i)
+      found += scope[*names[order[i & 0xffff]]].size();
+    double hash_ns = elapsed_ns(start, lookups);
+
+    std::printf("%8d decls: rb_tree %7.1f ns/lookup, hash_index %7.1f ns/lookup"
+                " (%.1fx)%s\n", scope_size, tree_ns, hash_ns, tree_ns / hash_ns,
+                found == 2 * lookups ? "" : "  MISMATCH");
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc > 1)
+    for (int i = 1; i < argc; ++i)
+      run(std::atoi(argv[i]));
+  else {
+    const int sizes[] = { 16, 256, 4096, 32768, 131072 };
+    for (std::size_t i = 0; i < sizeof sizes / sizeof sizes[0]; ++i)
+      run(sizes[i]);
+  }
+}
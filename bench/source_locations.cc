@@ -0,0 +1,187 @@
+// Times the file table of a unit against the linear list it replaced,
+// then the cost of giving every declaration of generated classes a
+// source location: build time, memory census and archive size.  The
+// locations are checked to survive the archive.
+//
+//   bench_source_locations [class-count] [file-count]
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <list>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ipr/archive.H"
+#include "fixture.H"
+
+using namespace ipr;
+using namespace bench;
+
+namespace {
+  // The former Unit::make_fileindex and Unit::to_filename.
+  struct linear_filemap {
+    std::list<std::string> files;
+
+    int make_fileindex(const std::string& s)
+    {
+      std::list<std::string>::iterator where =
+        std::find(files.begin(), files.end(), s);
+      const int i = std::distance(files.begin(), where);
+      if (where == files.end())
+        files.push_back(s);
+      return i;
+    }
+
+    const std::string& to_filename(int i) const
+    {
+      std::list<std::string>::const_iterator what = files.begin();
+      std::advance(what, i);
+      return *what;
+    }
+  };
+
+  std::string file_name(int i)
+  {
+    return "/usr/include/project/module_" + std::to_string(i) + ".h";
+  }
+
+  void time_file_tables(int files)
+  {
+    std::vector<std::string> names;
+    for (int i = 0; i < files; ++i)
+      names.push_back(file_name(i));
+
+    const int lookups = 200000;
+    long sum = 0;
+    linear_filemap linear;
+    clock_type::time_point start = clock_type::now();
+    for (int i = 0; i < lookups; ++i) {
+      const int f = linear.make_fileindex(names[i * 7919 % files]);
+      sum += linear.to_filename(f).size();
+    }
+    double linear_ms = elapsed_ms(start);
+
+    impl::Unit unit;
+    std::vector<const ipr::String*> interned;
+    for (int i = 0; i < files; ++i)
+      interned.push_back(&unit.get_string(names[i]));
+    start = clock_type::now();
+    for (int i = 0; i < lookups; ++i) {
+      const int f = unit.make_fileindex(*interned[i * 7919 % files]);
+      sum -= unit.to_filename(f).size();
+    }
+    double table_ms = elapsed_ms(start);
+
+    std::printf("%d files, %d lookups: list %.1f ms, table %.1f ms%s\n",
+                files, lookups, linear_ms, table_ms,
+                sum == 0 ? "" : "  MISMATCH");
+  }
+
+  // One header to each namespace, and a line to each declaration.
+  struct with_locations : class_layout {
+    int file;
+    int line;
+
+    with_locations() : file(0), line(0) { }
+
+    void add_to_namespace(impl::Unit& unit, impl::Namespace&, int c)
+    {
+      file = unit.make_fileindex(unit.get_string(file_name(c / 100)));
+    }
+
+    void add_to_class(impl::Unit&, impl::Class&, impl::Typedecl& td, int c)
+    {
+      line = 1 + (c % 100) * 16;
+      td.src_locus.file = file;
+      td.src_locus.line = line;
+      td.src_locus.column = 8;
+    }
+
+    void add_to_field(impl::Unit&, impl::Field& field, int f)
+    {
+      field.src_locus.file = file;
+      field.src_locus.line = line + 2 + f;
+      field.src_locus.column = f % 3 ? 7 : 10;
+    }
+  };
+
+  // Whether X in unit A and Y in unit B are the same location.
+  bool same(const ipr::Unit& a, const ipr::Source_location& x,
+            const ipr::Unit& b, const ipr::Source_location& y)
+  {
+    if (x.line != y.line || x.column != y.column)
+      return false;
+    if (x.file == 0 || y.file == 0)
+      return x.file == y.file;
+    const ipr::String& fa = a.to_filename(x.file);
+    const ipr::String& fb = b.to_filename(y.file);
+    return fa.size() == fb.size()
+      && std::equal(fa.begin(), fa.end(), fb.begin());
+  }
+
+  // Compare the locations of the classes of A and B, and of their members.
+  bool same_locations(const ipr::Unit& a, const ipr::Unit& b)
+  {
+    const ipr::Sequence<ipr::Decl>& na = a.get_global_scope().members();
+    const ipr::Sequence<ipr::Decl>& nb = b.get_global_scope().members();
+    if (na.size() != nb.size())
+      return false;
+    for (int i = 0; i < na.size(); ++i) {
+      const ipr::Scope& ca =
+        static_cast<const ipr::Udt&>(na[i].initializer()).scope();
+      const ipr::Scope& cb =
+        static_cast<const ipr::Udt&>(nb[i].initializer()).scope();
+      for (int j = 0; j < ca.size(); ++j) {
+        const ipr::Scope& fa =
+          static_cast<const ipr::Udt&>(ca[j].initializer()).scope();
+        const ipr::Scope& fb =
+          static_cast<const ipr::Udt&>(cb[j].initializer()).scope();
+        if (!same(a, ca[j].source_location(), b, cb[j].source_location()))
+          return false;
+        for (int k = 0; k < fa.size(); ++k)
+          if (!same(a, fa[k].source_location(), b, fb[k].source_location()))
+            return false;
+      }
+    }
+    return true;
+  }
+
+  void time_locations(int count, bool located)
+  {
+    clock_type::time_point start = clock_type::now();
+    impl::Unit unit;
+    if (located) {
+      with_locations layout;
+      make_classes(unit, count, layout);
+    }
+    else
+      make_classes(unit, count);
+    double build_ms = elapsed_ms(start);
+    const long long bytes = unit.usage().byte_count();
+
+    std::ostringstream os;
+    impl::write_archive(os, unit);
+    const std::string archive = os.str();
+    impl::Unit copy;
+    impl::read_archive(archive.data(), archive.data() + archive.size(), copy);
+
+    std::printf("%d classes %s locations: build %.1f ms, census %lld bytes,"
+                " archive %zu bytes%s\n", count,
+                located ? "with" : "without", build_ms, bytes,
+                archive.size(),
+                !located || same_locations(unit, copy) ? "" : "  MISMATCH");
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  const int count = argc > 1 ? std::atoi(argv[1]) : 20000;
+  const int files = argc > 2 ? std::atoi(argv[2]) : 200;
+
+  time_file_tables(files);
+  time_locations(count, false);
+  time_locations(count, true);
+}
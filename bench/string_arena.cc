@@ -0,0 +1,82 @@
+// Interns identifiers of various lengths in a string arena, and reports
+// the time, the page faults and where the bytes went.  Run it once per
+// configuration: freed chunks would be reused by the next one.
+//
+//   bench_string_arena [string-count] [chunk-kbytes] [huge]
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include "ipr/utility.H"
+#include "fixture.H"
+
+using namespace ipr;
+using namespace bench;
+
+namespace {
+  long page_faults()
+  {
+    rusage r;
+    getrusage(RUSAGE_SELF, &r);
+    return r.ru_minflt;
+  }
+
+  // Short names, generated member names and long qualified names.
+  std::vector<std::string> identifiers(int count)
+  {
+    std::vector<std::string> names;
+    for (int i = 0; i < count; ++i)
+      switch (i % 4) {
+      case 0:
+        names.push_back(char('a' + i % 26) + std::to_string(i % 10));
+        break;
+      case 1:
+        names.push_back("field_" + std::to_string(i));
+        break;
+      case 2:
+        names.push_back("get_" + std::to_string(i) + "_value");
+        break;
+      default:
+        names.push_back("ns_" + std::to_string(i)
+                        + "::detail::implementation_type");
+        break;
+      }
+    return names;
+  }
+
+  void run(const util::string::arena::options& opts,
+           const std::vector<std::string>& names)
+  {
+    const long faults = page_faults();
+    clock_type::time_point start = clock_type::now();
+    util::string::arena arena(opts);
+    for (std::size_t i = 0; i < names.size(); ++i)
+      arena.make_string(names[i].data(), names[i].size());
+    const double ms = elapsed_ms(start);
+
+    util::string::arena::statistics s = arena.stats();
+    std::printf("%zu strings (%zu tiny, %zu large), %zuK chunks%s:"
+                " %.1f ms, %ld faults\n", s.strings, s.tiny_strings,
+                s.large_strings, opts.chunk_size >> 10,
+                opts.huge_pages ? " in huge pages" : "", ms,
+                page_faults() - faults);
+    std::printf("  %zu bytes reserved in %zu chunks (%zu huge): %zu used,"
+                " %zu padding, %zu unused\n", s.reserved, s.chunks,
+                s.huge_chunks, s.used, s.padding, s.unused);
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  const int count = argc > 1 ? std::atoi(argv[1]) : 500000;
+  util::string::arena::options opts;
+  if (argc > 2)
+    opts.chunk_size = std::size_t(std::atoi(argv[2])) << 10;
+  opts.huge_pages = argc > 3 && std::string(argv[3]) == "huge";
+
+  run(opts, identifiers(count));
+}
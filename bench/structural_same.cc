@@ -0,0 +1,76 @@
+// Times structural comparison of DAG-shaped types built in two units:
+// a plain recursive comparison against structurally_same, which
+// memoizes fingerprints and proven pairs.
+//
+//   bench_structural_same [depth]
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "ipr/impl.H"
+#include "ipr/traversal.H"
+#include "fixture.H"
+
+using namespace ipr;
+using namespace bench;
+
+namespace {
+  // T(0) = int, T(k+1) = T(k) (T(k), T(k)*): each level refers to the
+  // previous one three times, so the tree is exponential in DEPTH.
+  const ipr::Type& build(impl::Unit& unit, int depth)
+  {
+    const ipr::Type* t = &unit.get_int();
+    for (int k = 0; k < depth; ++k) {
+      impl::ref_sequence<ipr::Type> params;
+      params.push_back(t);
+      params.push_back(&unit.get_pointer(*t));
+      t = &unit.get_function(unit.get_product(params), *t);
+    }
+    return *t;
+  }
+
+  // Recursion without memoization, over the nodes build() makes.
+  bool naive_same(const Type& x, const Type& y)
+  {
+    if (x.category != y.category)
+      return false;
+    if (const Function* f = util::view<Function>(x)) {
+      const Function& g = *util::view<Function>(y);
+      return naive_same(f->source(), g.source())
+        && naive_same(f->target(), g.target());
+    }
+    if (const Product* p = util::view<Product>(x)) {
+      const Product& q = *util::view<Product>(y);
+      if (p->size() != q.size())
+        return false;
+      for (int i = 0; i < p->size(); ++i)
+        if (!naive_same(p->operand()[i], q.operand()[i]))
+          return false;
+      return true;
+    }
+    if (const Pointer* p = util::view<Pointer>(x))
+      return naive_same(p->points_to(), util::view<Pointer>(y)->points_to());
+    return structurally_same(x, y);
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  const int depth = argc > 1 ? std::atoi(argv[1]) : 12;
+
+  impl::Unit a, b;
+  const ipr::Type& x = build(a, depth);
+  const ipr::Type& y = build(b, depth);
+
+  clock_type::time_point start = clock_type::now();
+  bool naive = naive_same(x, y);
+  double naive_ms = elapsed_ms(start);
+
+  start = clock_type::now();
+  bool memoized = structurally_same(x, y);
+  double memoized_ms = elapsed_ms(start);
+
+  std::printf("depth %d: recursive %.2f ms, memoized %.3f ms (%s)\n", depth,
+              naive_ms, memoized_ms,
+              naive && memoized ? "same" : "NOT SAME");
+}
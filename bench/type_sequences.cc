@@ -0,0 +1,81 @@
+// Builds a unit heavy in function types -- products of zero to four
+// parameter types -- and declarations, and counts the allocations made
+// on the way, and their bytes.
+//
+//   bench_type_sequences [class-count]
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#include "ipr/impl.H"
+#include "fixture.H"
+
+using namespace ipr;
+using namespace bench;
+
+namespace {
+  long long allocations = 0;
+  long long allocated = 0;
+}
+
+void* operator new(std::size_t n)
+{
+  ++allocations;
+  allocated += n;
+  if (void* p = std::malloc(n == 0 ? 1 : n))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+namespace {
+  // Each class gets member functions taking zero to four parameters,
+  // of types made of the class.
+  void fill(impl::Unit& unit, int count)
+  {
+    const ipr::Identifier& call = unit.get_identifier("call");
+    for (int c = 0; c < count; ++c) {
+      impl::Class& cls = *unit.make_class(*unit.global_region());
+      cls.id = &unit.get_identifier("class_" + std::to_string(c));
+      unit.global_scope()->make_typedecl(*cls.id, unit.get_class())->init
+        = &cls;
+
+      const ipr::Type* params[] = {
+        &unit.get_pointer(cls), &unit.get_int(), &unit.get_reference(cls),
+        &unit.get_double()
+      };
+      for (int n = 0; n <= 4; ++n) {
+        impl::ref_sequence<ipr::Type> seq;
+        for (int i = 0; i < n; ++i)
+          seq.push_back(params[i]);
+        const ipr::Function& f =
+          unit.get_function(unit.get_product(seq), unit.get_void());
+        cls.declare_fun(call, f);
+      }
+    }
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  const int count = argc > 1 ? std::atoi(argv[1]) : 20000;
+
+  const long long allocations_before = allocations;
+  const long long allocated_before = allocated;
+  clock_type::time_point start = clock_type::now();
+  {
+    impl::Unit unit;
+    fill(unit, count);
+    const double ms = elapsed_ms(start);
+    std::printf("%d classes, %d function types: %.1f ms, %lld allocations,"
+                " %lld bytes allocated\n", count, 5 * count, ms,
+                allocations - allocations_before,
+                allocated - allocated_before);
+  }
+}
@@ -0,0 +1,59 @@
+// Times writing a unit to a binary archive and reading it back, against
+// the time it took to build the unit; then mapping the archive and looking
+// at one class only.
+//
+//   bench_unit_archive [class-count] [archive-file]
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "ipr/archive.H"
+#include "fixture.H"
+
+using namespace ipr;
+using namespace bench;
+
+int main(int argc, char* argv[])
+{
+  const int count = argc > 1 ? std::atoi(argv[1]) : 20000;
+  const char* path = argc > 2 ? argv[2] : "bench_unit_archive.ipr";
+
+  clock_type::time_point start = clock_type::now();
+  impl::Unit unit;
+  make_classes(unit, count);
+  double build_ms = elapsed_ms(start);
+
+  start = clock_type::now();
+  std::ostringstream os;
+  impl::write_archive(os, unit);
+  const std::string archive = os.str();
+  double write_ms = elapsed_ms(start);
+
+  start = clock_type::now();
+  impl::Unit copy;
+  impl::read_archive(archive.data(), archive.data() + archive.size(), copy);
+  double read_ms = elapsed_ms(start);
+
+  std::printf("%d classes: build %.1f ms, write %.1f ms, read %.1f ms,"
+              " %zu bytes\n", count, build_ms, write_ms, read_ms,
+              archive.size());
+
+  std::ofstream(path, std::ios::binary) << archive;
+  start = clock_type::now();
+  impl::mapped_unit mapped(path);
+  const ipr::Typedecl& ns = static_cast<const ipr::Typedecl&>(
+    mapped.global_ns.scope()[mapped.get_identifier("ns_0")][0]);
+  const ipr::Class& cls = static_cast<const ipr::Class&>(
+    static_cast<const ipr::Typedecl&>(
+      static_cast<const ipr::Namespace&>(ns.initializer())
+        .scope()[mapped.get_identifier("class_0")][0]).initializer());
+  int fields = cls.scope().members().size();
+  double lookup_ms = elapsed_ms(start);
+
+  std::printf("mapped: one class of %d fields in %.1f ms\n", fields,
+              lookup_ms);
+  std::remove(path);
+}
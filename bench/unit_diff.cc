@@ -0,0 +1,106 @@
+// Diffs two units of generated classes: a copy of the same classes, then
+// one with a few edits -- a field whose type changed, a field removed, a
+// class added and an enumerator whose value changed.  Reports the time
+// and the changes found.
+//
+//   bench_unit_diff [class-count]
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "ipr/impl.H"
+#include "ipr/diff.H"
+#include "fixture.H"
+
+using namespace ipr;
+using namespace bench;
+
+namespace {
+  void fill_class(impl::Unit& unit, impl::Namespace& ns, const std::string& id,
+                  int skipped, int retyped)
+  {
+    impl::Class& cls = *unit.make_class(ns.body);
+    cls.id = &unit.get_identifier(id);
+    ns.declare_type(*cls.id, unit.get_class())->init = &cls;
+    const ipr::Type& ptr = unit.get_pointer(cls);
+    for (int f = 0; f < 12; ++f)
+      if (f != skipped)
+        cls.declare_field(unit.get_identifier("field_" + std::to_string(f)),
+                          f == retyped ? unit.get_long()
+                          : f % 3 ? unit.get_int() : ptr);
+  }
+
+  // Classes the way the generator makes them, one namespace per 100,
+  // each namespace with an enum.  EDITED makes the changes listed above.
+  void fill(impl::Unit& unit, int count, bool edited)
+  {
+    impl::Namespace* ns = 0;
+    for (int c = 0; c < count; ++c) {
+      if (c % 100 == 0) {
+        ns = unit.make_namespace(*unit.global_region());
+        ns->id = &unit.get_identifier("ns_" + std::to_string(c / 100));
+        unit.global_ns.declare_type(*ns->id, unit.get_namespace())->init = ns;
+
+        impl::Enum& e = *unit.make_enum(ns->body);
+        e.id = &unit.get_identifier("kind");
+        ns->declare_type(*e.id, unit.get_enum())->init = &e;
+        for (int k = 0; k < 4; ++k) {
+          const int value = edited && c == 100 && k == 2 ? 7 : k;
+          e.add_member(unit.get_identifier("kind_" + std::to_string(k)))
+            ->init = &unit.get_literal(unit.get_int(), std::to_string(value));
+        }
+        if (edited && c == 0)
+          fill_class(unit, *ns, "class_new", -1, -1);
+      }
+      fill_class(unit, *ns, "class_" + std::to_string(c),
+                 edited && c == 11 ? 5 : -1, edited && c == 7 ? 3 : -1);
+    }
+  }
+
+  const char* kind_name(impl::unit_change::Kind k)
+  {
+    switch (k) {
+    case impl::unit_change::added: return "added";
+    case impl::unit_change::removed: return "removed";
+    default: return "changed";
+    }
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  const int count = argc > 1 ? std::atoi(argv[1]) : 20000;
+
+  clock_type::time_point start = clock_type::now();
+  impl::Unit before;
+  fill(before, count, false);
+  double build_ms = elapsed_ms(start);
+
+  impl::Unit same;
+  fill(same, count, false);
+  impl::Unit edited;
+  fill(edited, count, true);
+
+  start = clock_type::now();
+  std::vector<impl::unit_change> none = impl::diff(before, same);
+  double same_ms = elapsed_ms(start);
+
+  start = clock_type::now();
+  std::vector<impl::unit_change> changes = impl::diff(before, edited);
+  double edited_ms = elapsed_ms(start);
+
+  std::printf("%d classes: build %.1f ms, diff of a copy %.1f ms"
+              " (%lu changes), diff of an edit %.1f ms (%lu changes)\n",
+              count, build_ms, same_ms, (unsigned long)none.size(),
+              edited_ms, (unsigned long)changes.size());
+  for (std::size_t i = 0; i < changes.size() && i < 8; ++i)
+    std::printf("  %-8s %s\n", kind_name(changes[i].kind),
+                changes[i].name.c_str());
+  if (changes.size() > 8)
+    std::printf("  ...\n");
+
+  // The class added, its 12 fields, and two changes for each other edit.
+  return none.empty() && changes.size() == 19 ? 0 : 1;
+}
@@ -0,0 +1,68 @@
+// Times impl::merge of many small units, each standing for one parsed
+// header, against the time it took to build them.
+//
+//   bench_unit_merge [unit-count [threads]]
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ipr/merge.H"
+#include "fixture.H"
+
+using namespace ipr;
+using namespace bench;
+
+namespace {
+  // A header declaring a few classes of its own, and repeating a
+  // namespace and class that every header declares.
+  void fill(impl::Unit& unit, int k)
+  {
+    impl::Class& common = *unit.make_class(*unit.global_region());
+    common.id = &unit.get_identifier("common");
+    unit.global_ns.declare_type(*common.id, unit.get_class())->init = &common;
+    common.declare_field(unit.get_identifier("next"), unit.get_pointer(common));
+
+    impl::Namespace& ns = *unit.make_namespace(*unit.global_region());
+    ns.id = &unit.get_identifier("project");
+    unit.global_ns.declare_type(*ns.id, unit.get_namespace())->init = &ns;
+
+    for (int c = 0; c < 8; ++c) {
+      impl::Class& cls = *unit.make_class(ns.body);
+      cls.id = &unit.get_identifier("class_" + std::to_string(k) + "_" + std::to_string(c));
+      ns.declare_type(*cls.id, unit.get_class())->init = &cls;
+      for (int f = 0; f < 12; ++f) {
+        const ipr::Type& t = unit.get_pointer(common);
+        cls.declare_field(unit.get_identifier("field_" + std::to_string(f)),
+                          f % 3 ? unit.get_int() : t);
+      }
+    }
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  const int count = argc > 1 ? std::atoi(argv[1]) : 2000;
+  const int threads = argc > 2 ? std::atoi(argv[2]) : 4;
+
+  clock_type::time_point start = clock_type::now();
+  std::vector<std::unique_ptr<impl::Unit> > units;
+  std::vector<const ipr::Unit*> sources;
+  for (int k = 0; k < count; ++k) {
+    units.push_back(std::unique_ptr<impl::Unit>(new impl::Unit));
+    fill(*units.back(), k);
+    sources.push_back(units.back().get());
+  }
+  double build_ms = elapsed_ms(start);
+
+  for (int t = 1; t <= threads; t *= 2) {
+    impl::Unit target;
+    start = clock_type::now();
+    impl::merge(target, sources.data(), sources.data() + count, t);
+    double merge_ms = elapsed_ms(start);
+    std::printf("%d units: build %.1f ms, merge with %d thread(s) %.1f ms\n",
+                count, build_ms, t, merge_ms);
+  }
+}
@@ -0,0 +1,59 @@
+// Takes the memory census of a unit of generated classes, and prints it
+// as JSON, with the time the census took against the time to build.
+//
+//   bench_unit_usage [class-count] [field-count]
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "ipr/impl.H"
+#include "fixture.H"
+
+using namespace ipr;
+using namespace bench;
+
+namespace {
+  // FIELDS fields and a member function to each class.
+  struct with_size : class_layout {
+    explicit with_size(int fields) : class_layout(100, fields) { }
+
+    void add_to_class(impl::Unit& unit, impl::Class& cls, impl::Typedecl&,
+                      int)
+    {
+      const ipr::Type& ptr = unit.get_pointer(cls);
+      impl::ref_sequence<ipr::Type> args;
+      args.push_back(&ptr);
+      const ipr::Function& fun =
+        unit.get_function(unit.get_product(args), unit.get_int());
+      impl::Fundecl* f = cls.declare_fun(unit.get_identifier("size"), fun);
+      impl::Mapping* m = unit.make_mapping(cls.body);
+      unit.make_parameter(unit.get_identifier("self"), ptr, *m);
+      f->init = m;
+    }
+  };
+}
+
+int main(int argc, char* argv[])
+{
+  const int count = argc > 1 ? std::atoi(argv[1]) : 20000;
+  const int fields = argc > 2 ? std::atoi(argv[2]) : 12;
+
+  clock_type::time_point start = clock_type::now();
+  impl::Unit unit;
+  with_size layout(fields);
+  make_classes(unit, count, layout);
+  double build_ms = elapsed_ms(start);
+
+  start = clock_type::now();
+  impl::memory_usage usage = unit.usage();
+  double usage_ms = elapsed_ms(start);
+
+  usage.write_json(std::cout);
+  std::cout << std::endl;
+  std::printf("%d classes: build %.1f ms, census %.3f ms,"
+              " %lld nodes (%d made), %lld bytes\n", count, build_ms,
+              usage_ms, usage.node_count(), stats::all_nodes_count(),
+              usage.byte_count());
+}
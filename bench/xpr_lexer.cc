@@ -0,0 +1,46 @@
+// Times tokenizing the XPR dump of a unit, read through a memory mapping.
+//
+//   bench_xpr_lexer [class-count] [xpr-file]
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#include "ipr/impl.H"
+#include "ipr/io.H"
+#include "ipr/lexer.H"
+#include "fixture.H"
+
+using namespace ipr;
+using namespace bench;
+
+int main(int argc, char* argv[])
+{
+  const int count = argc > 1 ? std::atoi(argv[1]) : 50000;
+  const char* path = argc > 2 ? argv[2] : "bench_xpr_lexer.xpr";
+
+  {
+    impl::Unit unit;
+    class_layout global(0);
+    make_classes(unit, count, global);
+    std::ofstream os(path);
+    Printer pp(os);
+    pp << unit;
+  }
+
+  impl::Unit unit;
+  xpr::Lexer lexer(unit);
+  clock_type::time_point start = clock_type::now();
+  lexer.input_file(path);
+  long tokens = 0;
+  for (; lexer.peek().kind != xpr::Token::EndOfInput; lexer.discard())
+    ++tokens;
+  double lex_ms = elapsed_ms(start);
+
+  std::ifstream is(path, std::ios::binary | std::ios::ate);
+  const double megabytes = is.tellg() / 1e6;
+  std::printf("%.1f MB, %ld tokens in %.1f ms: %.0f MB/s\n", megabytes,
+              tokens, lex_ms, megabytes / lex_ms * 1e3);
+  std::remove(path);
+}
@@ -0,0 +1,73 @@
+// Times printing a unit as XPR, straight to the stream, through the
+// Printer's buffer and with several threads, and checks that all give
+// the same bytes.
+//
+//   bench_xpr_printer [class-count] [xpr-file] [threads]
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+
+#include "ipr/impl.H"
+#include "ipr/io.H"
+#include "fixture.H"
+
+using namespace ipr;
+using namespace bench;
+
+namespace {
+  double print(const ipr::Unit& unit, const std::string& path, int buffer,
+               int threads = 1)
+  {
+    std::ofstream os(path.c_str());
+    clock_type::time_point start = clock_type::now();
+    {
+      Printer pp(os, buffer);
+      pp.threads(threads);
+      pp << unit;
+    }
+    os.flush();
+    return elapsed_ms(start);
+  }
+
+  std::string contents(const std::string& path)
+  {
+    std::ifstream is(path.c_str(), std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(is),
+                       std::istreambuf_iterator<char>());
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  const int count = argc > 1 ? std::atoi(argv[1]) : 50000;
+  const std::string path = argc > 2 ? argv[2] : "bench_xpr_printer.xpr";
+  const int threads = argc > 3 ? std::atoi(argv[3])
+                    : std::max(2U, std::thread::hardware_concurrency());
+  const std::string buffered_path = path + ".buffered";
+  const std::string threaded_path = path + ".threaded";
+
+  impl::Unit unit;
+  class_layout global(0);
+  make_classes(unit, count, global);
+
+  double stream_ms = print(unit, path, 0);
+  double buffered_ms = print(unit, buffered_path, 1 << 16);
+  double threaded_ms = print(unit, threaded_path, 1 << 16, threads);
+
+  std::string text = contents(path);
+  const bool same = text == contents(buffered_path)
+                    && text == contents(threaded_path);
+  std::printf("%.1f MB: stream %.1f ms, buffered %.1f ms (%.1fx), "
+              "%d threads %.1f ms (%.1fx), %s\n", text.size() / 1e6,
+              stream_ms, buffered_ms, stream_ms / buffered_ms, threads,
+              threaded_ms, stream_ms / threaded_ms,
+              same ? "same output" : "OUTPUT DIFFERS");
+  std::remove(path.c_str());
+  std::remove(buffered_path.c_str());
+  std::remove(threaded_path.c_str());
+}
@@ -0,0 +1,182 @@
+// Times reading the XPR dump of a unit back into a fresh unit, against
+// building the same unit directly, then checks that every field read
+// back has the type of the original -- down to which udt it names,
+// since classes of the same name print the same.  Also checks that a
+// name the reader cannot resolve to one udt is rejected.
+//
+//   bench_xpr_reader [class-count] [xpr-file]
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "ipr/impl.H"
+#include "ipr/io.H"
+#include "ipr/parser.H"
+#include "fixture.H"
+
+using namespace ipr;
+using namespace bench;
+
+namespace {
+  typedef std::map<const ipr::Node*, const ipr::Node*> udt_map;
+
+  // Classes the way the generator makes them, each with a nested class
+  // of the same name, "node", used by a field of the class.
+  void fill(impl::Unit& unit, int count)
+  {
+    const ipr::Identifier& node = unit.get_identifier("node");
+    for (int c = 0; c < count; ++c) {
+      impl::Class& cls = *unit.make_class(*unit.global_region());
+      cls.id = &unit.get_identifier("class_" + std::to_string(c));
+      unit.global_ns.declare_type(*cls.id, unit.get_class())->init = &cls;
+      impl::Class& inner = *unit.make_class(cls.body);
+      inner.id = &node;
+      cls.declare_type(node, unit.get_class())->init = &inner;
+      inner.declare_field(unit.get_identifier("next"),
+                          unit.get_pointer(inner));
+      for (int f = 0; f < 12; ++f) {
+        const ipr::Type& ptr = unit.get_pointer(f % 2 ? cls : inner);
+        cls.declare_field(unit.get_identifier("field_" + std::to_string(f)),
+                          f % 3 ? unit.get_int() : ptr);
+      }
+    }
+  }
+
+  const ipr::Node& udt_of(const ipr::Type& t)
+  {
+    if (t.category == pointer_cat)
+      return static_cast<const ipr::Pointer&>(t).points_to();
+    return t;
+  }
+
+  // Pair the udts of X and Y, which list the same declarations.
+  void pair_udts(const ipr::Scope& x, const ipr::Scope& y, udt_map& m)
+  {
+    for (int i = 0; i < x.size() && i < y.size(); ++i)
+      if (x[i].category == typedecl_cat && x[i].has_initializer()
+          && y[i].has_initializer()) {
+        const ipr::Expr& u = x[i].initializer();
+        const ipr::Expr& v = y[i].initializer();
+        m[&u] = &v;
+        if (u.category == class_cat && v.category == class_cat)
+          pair_udts(static_cast<const ipr::Class&>(u).scope(),
+                    static_cast<const ipr::Class&>(v).scope(), m);
+      }
+  }
+
+  // Count the fields of X whose type in Y is not the counterpart of
+  // theirs, after M.
+  int wrong_fields(const ipr::Scope& x, const ipr::Scope& y,
+                   const udt_map& m, int& fields)
+  {
+    int wrong = x.size() != y.size();
+    for (int i = 0; i < x.size() && i < y.size(); ++i) {
+      if (x[i].category == field_cat) {
+        ++fields;
+        const ipr::Node& u = udt_of(x[i].type());
+        const ipr::Node& v = udt_of(y[i].type());
+        udt_map::const_iterator p = m.find(&u);
+        wrong += y[i].category != field_cat
+          || x[i].type().category != y[i].type().category
+          || p == m.end() || p->second != &v;
+      }
+      else if (x[i].category == typedecl_cat && x[i].has_initializer()
+               && x[i].initializer().category == class_cat) {
+        udt_map::const_iterator p = m.find(&x[i].initializer());
+        wrong += wrong_fields(
+          static_cast<const ipr::Class&>(x[i].initializer()).scope(),
+          static_cast<const ipr::Class&>(*p->second).scope(), m, fields);
+      }
+    }
+    return wrong;
+  }
+
+  // A::Node, B::Node and X { f : B::Node* } print X's field as "Node",
+  // which the reader must not take for A::Node.
+  bool ambiguous_name_rejected()
+  {
+    std::ostringstream os;
+    {
+      impl::Unit unit;
+      const ipr::Identifier& node = unit.get_identifier("Node");
+      const impl::Class* b = 0;
+      for (int k = 0; k < 2; ++k) {
+        impl::Namespace& ns = *unit.make_namespace(*unit.global_region());
+        ns.id = &unit.get_identifier(k ? "B" : "A");
+        unit.global_ns.declare_type(*ns.id, unit.get_namespace())->init = &ns;
+        impl::Class& cls = *unit.make_class(ns.body);
+        cls.id = &node;
+        ns.declare_type(node, unit.get_class())->init = &cls;
+        cls.declare_field(unit.get_identifier(k ? "b" : "a"), unit.get_int());
+        b = &cls;
+      }
+      impl::Class& x = *unit.make_class(*unit.global_region());
+      x.id = &unit.get_identifier("X");
+      unit.global_ns.declare_type(*x.id, unit.get_class())->init = &x;
+      x.declare_field(unit.get_identifier("f"), unit.get_pointer(*b));
+      Printer pp(os);
+      pp << unit;
+    }
+    const std::string text = os.str();
+    impl::Unit unit;
+    xpr::Parser parser(unit);
+    parser.input(text.data(), text.data() + text.size());
+    try {
+      parser.translation_unit();
+    }
+    catch (const std::domain_error&) {
+      return true;
+    }
+    return false;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  const int count = argc > 1 ? std::atoi(argv[1]) : 20000;
+  const char* path = argc > 2 ? argv[2] : "bench_xpr_reader.xpr";
+
+  double build_ms;
+  impl::Unit original;
+  {
+    clock_type::time_point start = clock_type::now();
+    fill(original, count);
+    build_ms = elapsed_ms(start);
+    std::ofstream os(path);
+    Printer pp(os);
+    pp << original;
+  }
+
+  impl::Unit unit;
+  xpr::Parser parser(unit);
+  clock_type::time_point start = clock_type::now();
+  parser.input_file(path);
+  parser.translation_unit();
+  double read_ms = elapsed_ms(start);
+
+  std::ifstream is(path, std::ios::binary | std::ios::ate);
+  const double megabytes = is.tellg() / 1e6;
+  std::printf("%d classes: built in %.1f ms, %.1f MB of XPR read in "
+              "%.1f ms (%.0f MB/s)\n", count, build_ms, megabytes, read_ms,
+              megabytes / read_ms * 1e3);
+  is.close();
+  std::remove(path);
+
+  const ipr::Scope& x = original.get_global_scope().scope();
+  const ipr::Scope& y = unit.get_global_scope().scope();
+  udt_map counterpart;
+  counterpart[&original.get_int()] = &unit.get_int();
+  pair_udts(x, y, counterpart);
+  int fields = 0;
+  const int wrong = wrong_fields(x, y, counterpart, fields);
+  std::printf("%d fields read back, %d with the wrong type\n", fields, wrong);
+
+  const bool rejected = ambiguous_name_rejected();
+  std::printf("ambiguous udt name: %s\n", rejected ? "rejected" : "ACCEPTED");
+  return wrong == 0 && rejected ? 0 : 1;
+}
@@ -1,10 +1,14 @@
+#include <algorithm>
 #include <iostream>
 #include <memory>
+#include <thread>
+#include <vector>
 
 #include <clang/Tooling/Refactoring.h>
 #include <clang/Tooling/Tooling.h>
 #include <llvm/Support/CommandLine.h>
 #include <llvm/Support/Signals.h>
+#include <llvm/Support/Threading.h>
 
 #include "MetaClassGenerator.hh"
 
@@ -14,6 +18,8 @@ using namespace tooling;
 
 cl::opt<std::string> build_path(cl::Positional, cl::desc("<build-path>"));
 cl::list<std::string> source_paths(cl::Positional, cl::desc("<source0> [... <sourceN>]"), cl::OneOrMore);
+cl::opt<unsigned> jobs("j", cl::desc("Number of threads parsing the sources"), cl::init(1));
+cl::opt<std::string> ipr_output("o", cl::desc("Write the IPR of the sources to <file>"), cl::value_desc("file"));
 
   static void
 InitCompilationDatabase(std::shared_ptr<CompilationDatabase>& compilations)
@@ -36,15 +42,45 @@ int main(int argc, const char **argv)
 
   InitCompilationDatabase(compilations);
 
-  tooling::RefactoringTool tool(*compilations, source_paths);
-  ast_matchers::MatchFinder finder;
+  // Deal the sources out to the threads in runs of consecutive ones, so that the printers' reports, joined in order,
+  // follow the order of the sources; each thread has its own tool and printer, and they all build the same IPR.
+  unsigned threadCount = std::max(1u, std::min<unsigned>(jobs, source_paths.size()));
+  std::vector<std::vector<std::string> > paths(threadCount);
+  for (unsigned i = 0; i < source_paths.size(); ++i)
+    paths[i * threadCount / source_paths.size()].push_back(source_paths[i]);
 
-  ClassMembersPrinter& printer = GenerateSerialization(tool, finder);
+  if (threadCount > 1)
+    llvm::llvm_start_multithreaded();
 
-  std::unique_ptr<clang::tooling::FrontendActionFactory> frontendAction(newFrontendActionFactory(&finder));
+  std::vector<std::unique_ptr<tooling::RefactoringTool> > tools;
+  std::vector<std::unique_ptr<ast_matchers::MatchFinder> > finders;
+  std::vector<std::unique_ptr<clang::tooling::FrontendActionFactory> > frontendActions;
+  std::vector<ClassMembersPrinter*> printers;
+  for (unsigned i = 0; i < threadCount; ++i)
+  {
+    tools.emplace_back(new tooling::RefactoringTool(*compilations, paths[i]));
+    finders.emplace_back(new ast_matchers::MatchFinder);
+    printers.push_back(&GenerateSerialization(*tools[i], *finders[i]));
+    frontendActions.emplace_back(newFrontendActionFactory(finders[i].get()));
+  }
+
+  std::vector<int> results(threadCount);
+  std::vector<std::thread> threads;
+  for (unsigned i = 1; i < threadCount; ++i)
+    threads.emplace_back([&, i] { results[i] = tools[i]->run(frontendActions[i].get()); });
+  results[0] = tools[0]->run(frontendActions[0].get());
+  for (auto& thread : threads)
+    thread.join();
+
+  WriteMetaInfo(printers);
+
+  int res = 0;
+  for (unsigned i = 0; i < threadCount; ++i)
+    if (results[i] != 0)
+      res = results[i];
 
-  int res = tool.run(frontendAction.get());
-  WriteMetaInfo(printer);
+  if (!ipr_output.empty())
+    SaveIpr(ipr_output);
 
   return res;
 }